@@ -0,0 +1,161 @@
+#include "noirify.h"
+#include "../processors/cpp/noirify_core.h"
+#include "../processors/asm/noirify_simd.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace {
+    using namespace noirify_cpp;
+
+    constexpr long long MinPixelsPerThread = 1 << 18;
+
+    bool fitsInt(ptrdiff_t v) { return v >= INT_MIN && v <= INT_MAX; }
+
+    int bytesPerPixel(noirify_format fmt) {
+        return fmt == NOIRIFY_FORMAT_RGBA64 ? 8 : 4;
+    }
+
+    int bytesPerPixel(noirify_output out) {
+        return out == NOIRIFY_OUTPUT_GRAY16 ? 2 : 1;
+    }
+
+    int threadCount(const noirify_options& opts, int width, int height) {
+        const int maxBands = (height + 3) / 4;
+        if (opts.threads > 0) return std::min(opts.threads, maxBands);
+
+        const long long pixels = static_cast<long long>(width) * height;
+        const int hw = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        const int bySize = static_cast<int>(std::max(1LL, pixels / MinPixelsPerThread));
+        return std::min({hw, bySize, maxBands});
+    }
+
+    // Splits rows into bands starting on multiples of 4 (keeps the dither pattern
+    // continuous) and runs them on std::threads; the calling thread takes the first band.
+    template <typename Band>
+    void runBands(int height, int threads, const Band& band) {
+        if (threads <= 1) { band(0, height); return; }
+
+        const int rowsPerBand = (((height + threads - 1) / threads) + 3) & ~3;
+        std::vector<std::thread> workers;
+        for (int y0 = rowsPerBand; y0 < height; y0 += rowsPerBand) {
+            const int rows = std::min(rowsPerBand, height - y0);
+            try {
+                workers.emplace_back(band, y0, rows);
+            } catch (...) {
+                band(y0, rows);
+            }
+        }
+        band(0, std::min(rowsPerBand, height));
+        for (auto& w : workers) w.join();
+    }
+}
+
+extern "C" {
+
+void noirify_options_init(noirify_options* opts) {
+    if (!opts) return;
+    *opts = {};
+    opts->struct_size = sizeof(noirify_options);
+    opts->luma = NOIRIFY_LUMA_BT601;
+    opts->custom_r = 0.299f;
+    opts->custom_g = 0.587f;
+    opts->custom_b = 0.114f;
+    opts->output = NOIRIFY_OUTPUT_GRAY8;
+    opts->backend = NOIRIFY_BACKEND_AUTO;
+    opts->threads = 1;
+}
+
+noirify_status noirify_convert(const void* src, ptrdiff_t src_stride, noirify_format fmt,
+                               void* dst, ptrdiff_t dst_stride,
+                               int width, int height, const noirify_options* opts) {
+    noirify_options o;
+    noirify_options_init(&o);
+    if (opts) {
+        // Copy only the prefix the caller knows about; newer fields keep their defaults.
+        const size_t size = opts->struct_size;
+        if (size < NOIRIFY_OPTIONS_SIZE_V1 || size > sizeof(noirify_options)) return NOIRIFY_ERROR_INVALID_ARGUMENT;
+        std::memcpy(&o, opts, size);
+        o.struct_size = sizeof(noirify_options);
+    }
+
+    if (!src || !dst || width <= 0 || height <= 0) return NOIRIFY_ERROR_INVALID_ARGUMENT;
+    if (fmt < NOIRIFY_FORMAT_ARGB32 || fmt > NOIRIFY_FORMAT_RGBA64) return NOIRIFY_ERROR_INVALID_ARGUMENT;
+    if (o.output < NOIRIFY_OUTPUT_GRAY8 || o.output > NOIRIFY_OUTPUT_GRAY8_DITHERED) return NOIRIFY_ERROR_INVALID_ARGUMENT;
+    if (o.luma < NOIRIFY_LUMA_BT601 || o.luma > NOIRIFY_LUMA_CUSTOM) return NOIRIFY_ERROR_INVALID_ARGUMENT;
+    if (o.backend < NOIRIFY_BACKEND_AUTO || o.backend > NOIRIFY_BACKEND_ASM) return NOIRIFY_ERROR_INVALID_ARGUMENT;
+    if (o.threads < 0) return NOIRIFY_ERROR_INVALID_ARGUMENT;
+
+    if (std::llabs(src_stride) < static_cast<long long>(width) * bytesPerPixel(fmt)) return NOIRIFY_ERROR_INVALID_ARGUMENT;
+    if (std::llabs(dst_stride) < static_cast<long long>(width) * bytesPerPixel(o.output)) return NOIRIFY_ERROR_INVALID_ARGUMENT;
+
+    const auto preset = static_cast<LumaPreset>(o.luma);
+    const LumaWeights custom{o.custom_r, o.custom_g, o.custom_b};
+    if (preset == LumaPreset::Custom) {
+        const float sum = custom.r + custom.g + custom.b;
+        if (!std::isfinite(custom.r) || !std::isfinite(custom.g) || !std::isfinite(custom.b) || !std::isfinite(sum)
+            || custom.r < 0.0f || custom.g < 0.0f || custom.b < 0.0f || sum <= 0.0f) {
+            return NOIRIFY_ERROR_INVALID_ARGUMENT;
+        }
+    }
+
+    const int threads = threadCount(o, width, height);
+    const auto* srcBytes = static_cast<const uint8_t*>(src);
+    auto* dstBytes = static_cast<uint8_t*>(dst);
+
+    if (fmt != NOIRIFY_FORMAT_RGBA64) {
+        // The ASM 8-bit kernel works in place on RGBA8888, so caller buffers go through C++.
+        if (o.output != NOIRIFY_OUTPUT_GRAY8 || o.backend == NOIRIFY_BACKEND_ASM) return NOIRIFY_ERROR_UNSUPPORTED;
+
+        const auto layout = fmt == NOIRIFY_FORMAT_ARGB32 ? PixelLayout::ARGB32 : PixelLayout::RGBA8888;
+        runBands(height, threads, [&](int y0, int rows) {
+            grayscaleRows8(srcBytes + src_stride * y0, src_stride, layout,
+                           dstBytes + dst_stride * y0, dst_stride, width, rows, preset, custom);
+        });
+        return NOIRIFY_OK;
+    }
+
+    // 16-bit input to 8-bit output is always dithered, so the defaults work for RGBA64 too.
+    const bool dither = o.output != NOIRIFY_OUTPUT_GRAY16;
+
+    const bool asmStrides = fitsInt(src_stride) && fitsInt(dst_stride);
+    if (o.backend == NOIRIFY_BACKEND_ASM && !asmStrides) return NOIRIFY_ERROR_UNSUPPORTED;
+
+    if (o.backend != NOIRIFY_BACKEND_CPP && asmStrides) {
+        const LumaWeightsFixed f = toFixed(lumaWeights(preset, custom), 15);
+        const uint16_t weights[4] = {f.r, f.g, f.b, 0};
+        runBands(height, threads, [&](int y0, int rows) {
+            const auto* s = reinterpret_cast<const uint16_t*>(srcBytes + src_stride * y0);
+            uint8_t* d = dstBytes + dst_stride * y0;
+            if (dither) {
+                to_grayscale16_dither8_w(s, d, width, rows, int(src_stride), int(dst_stride), weights);
+            } else {
+                to_grayscale16_w(s, reinterpret_cast<uint16_t*>(d), width, rows,
+                                 int(src_stride), int(dst_stride), weights);
+            }
+        });
+        return NOIRIFY_OK;
+    }
+
+    const auto output = dither ? HighBitDepthOutput::Dithered8 : HighBitDepthOutput::Grayscale16;
+    runBands(height, threads, [&](int y0, int rows) {
+        grayscaleRows16(reinterpret_cast<const uint16_t*>(srcBytes + src_stride * y0), src_stride,
+                        dstBytes + dst_stride * y0, dst_stride, width, rows, output, preset, custom);
+    });
+    return NOIRIFY_OK;
+}
+
+const char* noirify_status_string(noirify_status status) {
+    switch (status) {
+        case NOIRIFY_OK:                     return "ok";
+        case NOIRIFY_ERROR_INVALID_ARGUMENT: return "invalid argument";
+        case NOIRIFY_ERROR_UNSUPPORTED:      return "unsupported format/output/backend combination";
+    }
+    return "unknown status";
+}
+
+}
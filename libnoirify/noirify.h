@@ -0,0 +1,94 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * libnoirify: grayscale conversion over caller-owned buffers.
+ * No Qt dependency; pixels are read and written in place, no copies are made.
+ */
+
+#if defined(_WIN32) && defined(NOIRIFY_SHARED)
+#  if defined(NOIRIFY_BUILDING)
+#    define NOIRIFY_API __declspec(dllexport)
+#  else
+#    define NOIRIFY_API __declspec(dllimport)
+#  endif
+#elif defined(__GNUC__) && defined(NOIRIFY_SHARED)
+#  define NOIRIFY_API __attribute__((visibility("default")))
+#else
+#  define NOIRIFY_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum noirify_format {
+    NOIRIFY_FORMAT_ARGB32   = 0,   /* native-endian 0xAARRGGBB words (QImage::Format_ARGB32 / RGB32) */
+    NOIRIFY_FORMAT_RGBA8888 = 1,   /* bytes R, G, B, A */
+    NOIRIFY_FORMAT_RGBA64   = 2    /* native-endian uint16 R, G, B, A (QImage::Format_RGBA64 / RGBX64) */
+} noirify_format;
+
+typedef enum noirify_output {
+    NOIRIFY_OUTPUT_GRAY8          = 0,   /* default; for RGBA64 input this behaves as GRAY8_DITHERED */
+    NOIRIFY_OUTPUT_GRAY16         = 1,   /* RGBA64 input only */
+    NOIRIFY_OUTPUT_GRAY8_DITHERED = 2    /* RGBA64 input only, 4x4 ordered dither */
+} noirify_output;
+
+typedef enum noirify_luma {
+    NOIRIFY_LUMA_BT601  = 0,
+    NOIRIFY_LUMA_BT709  = 1,
+    NOIRIFY_LUMA_BT2020 = 2,
+    NOIRIFY_LUMA_RED    = 3,
+    NOIRIFY_LUMA_GREEN  = 4,
+    NOIRIFY_LUMA_BLUE   = 5,
+    NOIRIFY_LUMA_CUSTOM = 6    /* uses custom_r/g/b: finite, non-negative, normalized to sum to 1 */
+} noirify_luma;
+
+typedef enum noirify_backend {
+    NOIRIFY_BACKEND_AUTO = 0,  /* ASM for RGBA64 input, C++ otherwise */
+    NOIRIFY_BACKEND_CPP  = 1,
+    NOIRIFY_BACKEND_ASM  = 2   /* RGBA64 input only */
+} noirify_backend;
+
+typedef enum noirify_status {
+    NOIRIFY_OK                     = 0,
+    NOIRIFY_ERROR_INVALID_ARGUMENT = 1,
+    NOIRIFY_ERROR_UNSUPPORTED      = 2
+} noirify_status;
+
+/*
+ * Versioned by struct_size: later releases only append fields. noirify_convert accepts
+ * any struct_size from NOIRIFY_OPTIONS_SIZE_V1 up to its own sizeof(noirify_options),
+ * reads that many leading bytes and takes defaults for the fields past them, so callers
+ * built against an older header keep working.
+ */
+typedef struct noirify_options {
+    uint32_t struct_size;          /* set by noirify_options_init */
+    noirify_luma luma;
+    float custom_r, custom_g, custom_b;
+    noirify_output output;
+    noirify_backend backend;
+    int threads;                   /* 0 = one per hardware thread, 1 = calling thread only */
+} noirify_options;
+
+/* Size of the first released layout (struct_size through threads). */
+#define NOIRIFY_OPTIONS_SIZE_V1 (offsetof(noirify_options, threads) + sizeof(int))
+
+/* Defaults: BT.601, GRAY8 output, AUTO backend, single-threaded. */
+NOIRIFY_API void noirify_options_init(noirify_options* opts);
+
+/*
+ * Converts a width x height image from src to dst. Strides are in bytes and may be
+ * negative for bottom-up buffers. opts may be NULL for defaults. Thread-safe: calls
+ * share no state, so buffers may be converted concurrently.
+ */
+NOIRIFY_API noirify_status noirify_convert(const void* src, ptrdiff_t src_stride, noirify_format fmt,
+                                           void* dst, ptrdiff_t dst_stride,
+                                           int width, int height, const noirify_options* opts);
+
+NOIRIFY_API const char* noirify_status_string(noirify_status status);
+
+#ifdef __cplusplus
+}
+#endif
@@ -3,8 +3,24 @@
 
 extern "C" {
 
-    void set_rgb(uint8_t r, uint8_t g, uint8_t b);
+    // Luma weights in 1/256 units (expected to sum to 256), used by to_grayscale.
+    void set_rgb(uint16_t r, uint16_t g, uint16_t b);
 
     void to_grayscale(uint8_t* buffer, int width, int height);
 
-}
\ No newline at end of file
+    // 16-bit path. Weights in 1/32768 units (expected to sum to 32768).
+    void set_rgb16(uint16_t r, uint16_t g, uint16_t b);
+
+    // src: RGBA64/RGBX64 rows; strides in bytes.
+    void to_grayscale16(const uint16_t* src, uint16_t* dst, int width, int height,
+                        int src_stride, int dst_stride);
+    void to_grayscale16_dither8(const uint16_t* src, uint8_t* dst, int width, int height,
+                                int src_stride, int dst_stride);
+
+    // Reentrant variants: weights = {r, g, b, 0} in 1/32768 units instead of the set_rgb16 state.
+    void to_grayscale16_w(const uint16_t* src, uint16_t* dst, int width, int height,
+                          int src_stride, int dst_stride, const uint16_t* weights);
+    void to_grayscale16_dither8_w(const uint16_t* src, uint8_t* dst, int width, int height,
+                                  int src_stride, int dst_stride, const uint16_t* weights);
+
+}
@@ -0,0 +1,258 @@
+#include "noirify_core.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+
+namespace noirify_cpp {
+    namespace {
+        constexpr LumaWeights presetWeights(LumaPreset preset) {
+            switch (preset) {
+                case LumaPreset::BT709:  return {0.2126f, 0.7152f, 0.0722f};
+                case LumaPreset::BT2020: return {0.2627f, 0.6780f, 0.0593f};
+                case LumaPreset::Red:    return {1.0f, 0.0f, 0.0f};
+                case LumaPreset::Green:  return {0.0f, 1.0f, 0.0f};
+                case LumaPreset::Blue:   return {0.0f, 0.0f, 1.0f};
+                case LumaPreset::BT601:
+                case LumaPreset::Custom:
+                default:                 return {0.299f, 0.587f, 0.114f};
+            }
+        }
+
+        constexpr LumaWeightsFixed fixedWeights(const LumaWeights& w, int fractionBits) {
+            const int one = 1 << fractionBits;
+            const int r = static_cast<int>(w.r * static_cast<float>(one) + 0.5f);
+            const int b = static_cast<int>(w.b * static_cast<float>(one) + 0.5f);
+            const int g = std::clamp(one - r - b, 0, one);
+            return {static_cast<uint16_t>(std::clamp(r, 0, one)),
+                    static_cast<uint16_t>(g),
+                    static_cast<uint16_t>(std::clamp(b, 0, one))};
+        }
+
+        constexpr int Fixed16Bits = 15;
+
+        // Same thresholds as bayer4 in noirify_simd.S, so both backends dither identically.
+        constexpr uint32_t Bayer4[4][4] = {
+            {  8, 136,  40, 168},
+            {200,  72, 232, 104},
+            { 56, 184,  24, 152},
+            {248, 120, 216,  88},
+        };
+
+        template <typename T>
+        const T* rowAt(const void* base, ptrdiff_t stride, int y) {
+            return reinterpret_cast<const T*>(static_cast<const uint8_t*>(base) + stride * y);
+        }
+
+        template <typename T>
+        T* rowAt(void* base, ptrdiff_t stride, int y) {
+            return reinterpret_cast<T*>(static_cast<uint8_t*>(base) + stride * y);
+        }
+
+        struct Rgb8 { int r, g, b; };
+
+        template <PixelLayout L>
+        Rgb8 loadPixel(const uint8_t* row, int x) {
+            if constexpr (L == PixelLayout::ARGB32) {
+                const uint32_t px = reinterpret_cast<const uint32_t*>(row)[x];
+                return {static_cast<int>((px >> 16) & 0xff), static_cast<int>((px >> 8) & 0xff), static_cast<int>(px & 0xff)};
+            } else {
+                return {row[4 * x + 0], row[4 * x + 1], row[4 * x + 2]};
+            }
+        }
+
+        // Presets are instantiated per weight set so the multipliers are compile-time
+        // constants; single-channel presets reduce to a plain channel copy.
+        template <LumaPreset P, PixelLayout L>
+        void convertRows(const uint8_t* src, ptrdiff_t srcStride, uint8_t* dst, ptrdiff_t dstStride,
+                         int width, int height) {
+            constexpr LumaWeights W = presetWeights(P);
+
+            for (int y = 0; y < height; ++y) {
+                const auto* srcRow = rowAt<uint8_t>(src, srcStride, y);
+                auto* dstRow = rowAt<uint8_t>(dst, dstStride, y);
+                for (int x = 0; x < width; ++x) {
+                    const Rgb8 px = loadPixel<L>(srcRow, x);
+                    if constexpr (P == LumaPreset::Red) {
+                        dstRow[x] = static_cast<uint8_t>(px.r);
+                    } else if constexpr (P == LumaPreset::Green) {
+                        dstRow[x] = static_cast<uint8_t>(px.g);
+                    } else if constexpr (P == LumaPreset::Blue) {
+                        dstRow[x] = static_cast<uint8_t>(px.b);
+                    } else {
+                        const float luma = px.r * W.r + px.g * W.g + px.b * W.b;
+                        dstRow[x] = static_cast<uint8_t>(luma);
+                    }
+                }
+            }
+        }
+
+        template <PixelLayout L>
+        void convertRowsGeneric(const uint8_t* src, ptrdiff_t srcStride, uint8_t* dst, ptrdiff_t dstStride,
+                                int width, int height, const LumaWeights& w) {
+            for (int y = 0; y < height; ++y) {
+                const auto* srcRow = rowAt<uint8_t>(src, srcStride, y);
+                auto* dstRow = rowAt<uint8_t>(dst, dstStride, y);
+                for (int x = 0; x < width; ++x) {
+                    const Rgb8 px = loadPixel<L>(srcRow, x);
+                    const float luma = px.r * w.r + px.g * w.g + px.b * w.b;
+                    dstRow[x] = static_cast<uint8_t>(std::min(luma, 255.0f));
+                }
+            }
+        }
+
+        template <PixelLayout L>
+        void dispatchRows8(const uint8_t* src, ptrdiff_t srcStride, uint8_t* dst, ptrdiff_t dstStride,
+                           int width, int height, LumaPreset preset, const LumaWeights& custom) {
+            switch (preset) {
+                case LumaPreset::BT601:  convertRows<LumaPreset::BT601, L>(src, srcStride, dst, dstStride, width, height);  break;
+                case LumaPreset::BT709:  convertRows<LumaPreset::BT709, L>(src, srcStride, dst, dstStride, width, height);  break;
+                case LumaPreset::BT2020: convertRows<LumaPreset::BT2020, L>(src, srcStride, dst, dstStride, width, height); break;
+                case LumaPreset::Red:    convertRows<LumaPreset::Red, L>(src, srcStride, dst, dstStride, width, height);    break;
+                case LumaPreset::Green:  convertRows<LumaPreset::Green, L>(src, srcStride, dst, dstStride, width, height);  break;
+                case LumaPreset::Blue:   convertRows<LumaPreset::Blue, L>(src, srcStride, dst, dstStride, width, height);   break;
+                case LumaPreset::Custom:
+                    convertRowsGeneric<L>(src, srcStride, dst, dstStride, width, height, lumaWeights(preset, custom));
+                    break;
+            }
+        }
+
+#if defined(__SSE2__) || defined(_M_X64)
+        // Four RGBA64 pixels -> four rounded luma values (dword lanes). Same arithmetic as
+        // LUMA16_PAIR in noirify_simd.S: pmullw/pmulhuw give exact 32-bit channel products.
+        inline __m128i luma16x4(const uint16_t* px, __m128i weights, __m128i round) {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(px));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(px + 8));
+
+            const __m128i aLo = _mm_mullo_epi16(a, weights), aHi = _mm_mulhi_epu16(a, weights);
+            const __m128i bLo = _mm_mullo_epi16(b, weights), bHi = _mm_mulhi_epu16(b, weights);
+            const __m128i p0 = _mm_unpacklo_epi16(aLo, aHi);   // r g b a products, pixel 0
+            const __m128i p1 = _mm_unpackhi_epi16(aLo, aHi);
+            const __m128i p2 = _mm_unpacklo_epi16(bLo, bHi);
+            const __m128i p3 = _mm_unpackhi_epi16(bLo, bHi);
+
+            // Horizontal sums of p0..p3 into one vector.
+            const __m128i s01 = _mm_add_epi32(_mm_unpacklo_epi32(p0, p1), _mm_unpackhi_epi32(p0, p1));
+            const __m128i s23 = _mm_add_epi32(_mm_unpacklo_epi32(p2, p3), _mm_unpackhi_epi32(p2, p3));
+            const __m128i sum = _mm_add_epi32(_mm_unpacklo_epi64(s01, s23), _mm_unpackhi_epi64(s01, s23));
+            return _mm_srli_epi32(_mm_add_epi32(sum, round), Fixed16Bits);
+        }
+#endif
+
+        // SSE2 main loop, four pixels per step, with a scalar tail (and scalar fallback on
+        // non-SSE2 targets). Custom weights arrive at runtime; every other preset is a
+        // compile-time constant. Single-channel presets use weight 32768, which is exact.
+        template <LumaPreset P, HighBitDepthOutput O>
+        void convertRows16(const uint16_t* src, ptrdiff_t srcStride, void* dst, ptrdiff_t dstStride,
+                           int width, int height, const LumaWeightsFixed& custom) {
+            constexpr LumaWeightsFixed Preset = fixedWeights(presetWeights(P), Fixed16Bits);
+            const LumaWeightsFixed w = P == LumaPreset::Custom ? custom : Preset;
+            const uint32_t wr = w.r, wg = w.g, wb = w.b;
+
+#if defined(__SSE2__) || defined(_M_X64)
+            const __m128i weights = _mm_setr_epi16(short(w.r), short(w.g), short(w.b), 0,
+                                                   short(w.r), short(w.g), short(w.b), 0);
+            const __m128i round = _mm_set1_epi32(1 << (Fixed16Bits - 1));
+#endif
+
+            for (int y = 0; y < height; ++y) {
+                const auto* srcRow = rowAt<uint16_t>(src, srcStride, y);
+                [[maybe_unused]] auto* dst16 = rowAt<uint16_t>(dst, dstStride, y);
+                [[maybe_unused]] auto* dst8 = rowAt<uint8_t>(dst, dstStride, y);
+                [[maybe_unused]] const uint32_t* dither = Bayer4[y & 3];
+
+                int x = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+                // x advances by 4, so the row's four thresholds line up with the lanes.
+                [[maybe_unused]] const __m128i thresholds =
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(dither));
+                for (; x + 4 <= width; x += 4) {
+                    const __m128i luma = luma16x4(srcRow + 4 * x, weights, round);
+                    if constexpr (O == HighBitDepthOutput::Grayscale16) {
+                        // sign-extend the low word so the signed pack keeps the 16-bit pattern
+                        const __m128i words = _mm_srai_epi32(_mm_slli_epi32(luma, 16), 16);
+                        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst16 + x), _mm_packs_epi32(words, words));
+                    } else {
+                        const __m128i v = _mm_srli_epi32(_mm_add_epi32(luma, thresholds), 8);
+                        const __m128i w16 = _mm_packs_epi32(v, v);
+                        const int bytes = _mm_cvtsi128_si32(_mm_packus_epi16(w16, w16));   // saturates 256 -> 255
+                        std::memcpy(dst8 + x, &bytes, 4);
+                    }
+                }
+#endif
+                for (; x < width; ++x) {
+                    const uint32_t r = srcRow[4 * x + 0];
+                    const uint32_t g = srcRow[4 * x + 1];
+                    const uint32_t b = srcRow[4 * x + 2];
+
+                    uint32_t luma;
+                    if constexpr (P == LumaPreset::Red)        luma = r;
+                    else if constexpr (P == LumaPreset::Green) luma = g;
+                    else if constexpr (P == LumaPreset::Blue)  luma = b;
+                    else luma = (r * wr + g * wg + b * wb + (1u << (Fixed16Bits - 1))) >> Fixed16Bits;
+
+                    if constexpr (O == HighBitDepthOutput::Grayscale16) {
+                        dst16[x] = static_cast<uint16_t>(luma);
+                    } else {
+                        dst8[x] = static_cast<uint8_t>(std::min(255u, (luma + dither[x & 3]) >> 8));
+                    }
+                }
+            }
+        }
+
+        template <HighBitDepthOutput O>
+        void dispatchRows16(const uint16_t* src, ptrdiff_t srcStride, void* dst, ptrdiff_t dstStride,
+                            int width, int height, LumaPreset preset, const LumaWeights& custom) {
+            const LumaWeightsFixed w = fixedWeights(lumaWeights(preset, custom), Fixed16Bits);
+            switch (preset) {
+                case LumaPreset::BT601:  convertRows16<LumaPreset::BT601, O>(src, srcStride, dst, dstStride, width, height, w);  break;
+                case LumaPreset::BT709:  convertRows16<LumaPreset::BT709, O>(src, srcStride, dst, dstStride, width, height, w);  break;
+                case LumaPreset::BT2020: convertRows16<LumaPreset::BT2020, O>(src, srcStride, dst, dstStride, width, height, w); break;
+                case LumaPreset::Red:    convertRows16<LumaPreset::Red, O>(src, srcStride, dst, dstStride, width, height, w);    break;
+                case LumaPreset::Green:  convertRows16<LumaPreset::Green, O>(src, srcStride, dst, dstStride, width, height, w);  break;
+                case LumaPreset::Blue:   convertRows16<LumaPreset::Blue, O>(src, srcStride, dst, dstStride, width, height, w);   break;
+                case LumaPreset::Custom: convertRows16<LumaPreset::Custom, O>(src, srcStride, dst, dstStride, width, height, w); break;
+            }
+        }
+    }
+
+    LumaWeights lumaWeights(LumaPreset preset, const LumaWeights& custom) {
+        if (preset != LumaPreset::Custom) return presetWeights(preset);
+
+        const float sum = custom.r + custom.g + custom.b;
+        if (!std::isfinite(custom.r) || !std::isfinite(custom.g) || !std::isfinite(custom.b) || !std::isfinite(sum)
+            || custom.r < 0.0f || custom.g < 0.0f || custom.b < 0.0f || sum <= 0.0f) {
+            return presetWeights(LumaPreset::BT601);
+        }
+        return {custom.r / sum, custom.g / sum, custom.b / sum};
+    }
+
+    LumaWeightsFixed toFixed(const LumaWeights& w, int fractionBits) {
+        return fixedWeights(w, fractionBits);
+    }
+
+    void grayscaleRows8(const uint8_t* src, ptrdiff_t srcStride, PixelLayout layout,
+                        uint8_t* dst, ptrdiff_t dstStride, int width, int height,
+                        LumaPreset preset, const LumaWeights& custom) {
+        if (layout == PixelLayout::ARGB32) {
+            dispatchRows8<PixelLayout::ARGB32>(src, srcStride, dst, dstStride, width, height, preset, custom);
+        } else {
+            dispatchRows8<PixelLayout::RGBA8888>(src, srcStride, dst, dstStride, width, height, preset, custom);
+        }
+    }
+
+    void grayscaleRows16(const uint16_t* src, ptrdiff_t srcStride,
+                         void* dst, ptrdiff_t dstStride, int width, int height,
+                         HighBitDepthOutput output, LumaPreset preset, const LumaWeights& custom) {
+        if (output == HighBitDepthOutput::Dithered8) {
+            dispatchRows16<HighBitDepthOutput::Dithered8>(src, srcStride, dst, dstStride, width, height, preset, custom);
+        } else {
+            dispatchRows16<HighBitDepthOutput::Grayscale16>(src, srcStride, dst, dstStride, width, height, preset, custom);
+        }
+    }
+
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Qt-free grayscale kernels over caller-owned row buffers. Shared by the QImage
+// wrappers in noirify_cpp.h and by libnoirify.
+namespace noirify_cpp {
+
+    enum class LumaPreset { BT601, BT709, BT2020, Red, Green, Blue, Custom };
+
+    struct LumaWeights { float r, g, b; };
+
+    // Weights in 1/2^fractionBits units summing to 2^fractionBits:
+    // 8 bits for the ASM set_rgb, 15 bits for set_rgb16.
+    struct LumaWeightsFixed { uint16_t r, g, b; };
+
+    enum class HighBitDepthOutput { Grayscale16, Dithered8 };
+
+    // ARGB32: native-endian 0xAARRGGBB words (QImage::Format_ARGB32/RGB32).
+    // RGBA8888: bytes R, G, B, A in memory order.
+    enum class PixelLayout { ARGB32, RGBA8888 };
+
+    // Custom weights are normalized to sum to 1; invalid ones (non-finite, negative or zero sum) fall back to BT.601.
+    LumaWeights lumaWeights(LumaPreset preset, const LumaWeights& custom = {});
+    LumaWeightsFixed toFixed(const LumaWeights& w, int fractionBits = 8);
+
+    // 8-bit RGB rows -> Grayscale8 rows. Strides are in bytes and may be negative.
+    void grayscaleRows8(const uint8_t* src, ptrdiff_t srcStride, PixelLayout layout,
+                        uint8_t* dst, ptrdiff_t dstStride, int width, int height,
+                        LumaPreset preset, const LumaWeights& custom = {});
+
+    // RGBA64 rows (R, G, B, A uint16 in memory order) -> Grayscale16 rows, or Grayscale8
+    // rows with a 4x4 ordered dither for Dithered8. The dither pattern is anchored at the
+    // first row passed in, so row bands should start on multiples of 4.
+    void grayscaleRows16(const uint16_t* src, ptrdiff_t srcStride,
+                         void* dst, ptrdiff_t dstStride, int width, int height,
+                         HighBitDepthOutput output, LumaPreset preset, const LumaWeights& custom = {});
+
+}
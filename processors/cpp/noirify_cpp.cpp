@@ -3,35 +3,45 @@
 
 
 namespace noirify_cpp {
-    namespace {
-        constexpr float RW = 0.299f;
-        constexpr float GW = 0.587f;
-        constexpr float BW = 0.114f;
+
+    bool isHighBitDepth(const QImage& img) {
+        switch (img.format()) {
+            case QImage::Format_Grayscale16:
+            case QImage::Format_BGR30:
+            case QImage::Format_A2BGR30_Premultiplied:
+            case QImage::Format_RGB30:
+            case QImage::Format_A2RGB30_Premultiplied:
+                return true;
+            default:
+                return img.depth() > 32;
+        }
     }
 
-    QImage convertToGrayscale(const QImage& src) {
+    QImage convertToGrayscale(const QImage& src, LumaPreset preset, const LumaWeights& custom) {
         if (src.isNull()) return {};
+        if (isHighBitDepth(src)) return convertToGrayscale16(src, HighBitDepthOutput::Grayscale16, preset, custom);
 
         const QImage rgb = src.convertToFormat(QImage::Format_ARGB32);
         QImage dst(rgb.size(), QImage::Format_Grayscale8);
 
-        const int width = rgb.width();
-        const int height = rgb.height();
-
-        for (int y = 0; y < height; ++y) {
-            const auto* srcRow = reinterpret_cast<const QRgb*>(rgb.constScanLine(y));
-            auto* dstRow = dst.scanLine(y);
-            for (int x = 0; x < width; ++x) {
-                const QRgb px = srcRow[x];
-                const int r = qRed(px);
-                const int g = qGreen(px);
-                const int b = qBlue(px);
-                const float luma = r * RW + g * GW + b * BW;
-                dstRow[x] = static_cast<uchar>(luma);
-            }
-        }
+        grayscaleRows8(rgb.constBits(), rgb.bytesPerLine(), PixelLayout::ARGB32,
+                       dst.bits(), dst.bytesPerLine(), rgb.width(), rgb.height(), preset, custom);
+
+        return dst;
+    }
+
+    QImage convertToGrayscale16(const QImage& src, HighBitDepthOutput output,
+                                LumaPreset preset, const LumaWeights& custom) {
+        if (src.isNull()) return {};
+
+        const bool native = src.format() == QImage::Format_RGBA64 || src.format() == QImage::Format_RGBX64;
+        const QImage rgba = native ? src : src.convertToFormat(QImage::Format_RGBA64);
 
+        QImage dst(rgba.size(), output == HighBitDepthOutput::Dithered8 ? QImage::Format_Grayscale8
+                                                                         : QImage::Format_Grayscale16);
+        grayscaleRows16(reinterpret_cast<const uint16_t*>(rgba.constBits()), rgba.bytesPerLine(),
+                        dst.bits(), dst.bytesPerLine(), rgba.width(), rgba.height(), output, preset, custom);
         return dst;
     }
 
-}
\ No newline at end of file
+}
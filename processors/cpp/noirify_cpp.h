@@ -1,8 +1,22 @@
 #pragma once
 #include <QImage>
+#include "noirify_core.h"
 
 namespace noirify_cpp {
 
-    QImage convertToGrayscale(const QImage& src);
+    // More than 8 bits per channel (RGBA64, RGBX64, Grayscale16, 10-bit, float formats).
+    bool isHighBitDepth(const QImage& img);
 
-}
\ No newline at end of file
+    // High bit depth inputs are routed to convertToGrayscale16 and come back as Grayscale16.
+    QImage convertToGrayscale(const QImage& src,
+                              LumaPreset preset = LumaPreset::BT601,
+                              const LumaWeights& custom = {});
+
+    // Reads RGBA64/RGBX64 directly (other formats are converted to RGBA64 first).
+    // Dithered8 applies a 4x4 ordered dither and returns Grayscale8 in the same pass.
+    QImage convertToGrayscale16(const QImage& src,
+                                HighBitDepthOutput output = HighBitDepthOutput::Grayscale16,
+                                LumaPreset preset = LumaPreset::BT601,
+                                const LumaWeights& custom = {});
+
+}
@@ -1,5 +1,6 @@
 from __future__ import annotations
 
+import math
 import sys
 from pathlib import Path
 from typing import Tuple
@@ -7,32 +8,62 @@ from typing import Tuple
 import numpy as np
 from PIL import Image
 
-_LUMA_WEIGHTS: Tuple[float, float, float] = (0.299, 0.587, 0.114)
+_LUMA_PRESETS: dict[str, Tuple[float, float, float]] = {
+    "bt601": (0.299, 0.587, 0.114),
+    "bt709": (0.2126, 0.7152, 0.0722),
+    "bt2020": (0.2627, 0.6780, 0.0593),
+}
+_CHANNELS: dict[str, int] = {"red": 0, "green": 1, "blue": 2}
+_DEFAULT_WEIGHTS = "bt601"
+
+def _parse_weights(spec: str) -> Tuple[float, float, float] | int:
+    """Return a preset/custom weight triple, or a channel index for single-channel presets."""
+    key = spec.strip().lower()
+    if key in _LUMA_PRESETS:
+        return _LUMA_PRESETS[key]
+    if key in _CHANNELS:
+        return _CHANNELS[key]
+
+    parts = key.split(",")
+    if len(parts) != 3:
+        raise ValueError(f"Unknown luma weights: {spec}")
+    r, g, b = (float(p) for p in parts)
+    total = r + g + b
+    if not all(math.isfinite(v) for v in (r, g, b, total)) or min(r, g, b) < 0 or total <= 0:
+        raise ValueError(f"Invalid luma weights: {spec}")
+    return (r / total, g / total, b / total)
 
 def _load_image(path: Path) -> Image.Image:
     if path.exists():
         return Image.open(path)
     raise FileNotFoundError(f"Input image not found: {path}")
 
-def convert_to_grayscale(src_path: Path, dst_path: Path) -> None:
+def convert_to_grayscale(src_path: Path, dst_path: Path, weights: str = _DEFAULT_WEIGHTS) -> None:
+    parsed = _parse_weights(weights)
     img = _load_image(src_path).convert("RGB")
     rgb = np.asarray(img, dtype=np.uint8)
 
-    luma = np.rint(rgb @ np.array(_LUMA_WEIGHTS, dtype=np.float32)).astype(np.uint8)
+    if isinstance(parsed, int):
+        luma = np.ascontiguousarray(rgb[..., parsed])
+    else:
+        luma = np.rint(rgb @ np.array(parsed, dtype=np.float32)).clip(0, 255).astype(np.uint8)
 
     gray_img = Image.fromarray(luma, mode="L")
     dst_path.parent.mkdir(parents=True, exist_ok=True)
     gray_img.save(dst_path)
 
 def _main(argv: list[str]) -> int:
-    if len(argv) != 3:
-        sys.stderr.write("Usage: python noirify.py <input_path> <output_path>\n")
+    if len(argv) not in (3, 4):
+        sys.stderr.write(
+            "Usage: python noirify.py <input_path> <output_path> "
+            "[bt601|bt709|bt2020|red|green|blue|R,G,B]\n")
         return 1
 
     src = Path(argv[1])
     dst = Path(argv[2])
+    weights = argv[3] if len(argv) == 4 else _DEFAULT_WEIGHTS
     try:
-        convert_to_grayscale(src, dst)
+        convert_to_grayscale(src, dst, weights)
     except Exception as exc:
         sys.stderr.write(f"Error: {exc}\n")
         return 1
@@ -22,8 +22,10 @@
 #include <QToolButton>
 #include <QKeySequence>
 #include <QStandardPaths>
+#include <QActionGroup>
+#include <QInputDialog>
+#include <QtNumeric>
 
-#include "../processors/cpp/noirify_cpp.h"
 #include "../processors/asm/noirify_simd.h"
 
 ThrobberWidget::ThrobberWidget(QWidget* parent) : QWidget(parent) {
@@ -99,6 +101,33 @@ void MainWindow::setupUi() {
     auto actRunAll= runMenu->addAction("Run All (C++ / ASM / Python)");
     connect(actRunAll, &QAction::triggered, this, &MainWindow::onRunAll);
 
+    using noirify_cpp::LumaPreset;
+    auto weightsMenu = runMenu->addMenu("Luma Weights");
+    auto weightsGroup = new QActionGroup(this);
+    const std::pair<const char*, LumaPreset> presets[] = {
+        {"BT.601",       LumaPreset::BT601},
+        {"BT.709",       LumaPreset::BT709},
+        {"BT.2020",      LumaPreset::BT2020},
+        {"Red channel",  LumaPreset::Red},
+        {"Green channel",LumaPreset::Green},
+        {"Blue channel", LumaPreset::Blue},
+        {"Custom...",    LumaPreset::Custom},
+    };
+    for (const auto& [label, preset] : presets) {
+        auto act = weightsMenu->addAction(label);
+        act->setCheckable(true);
+        act->setData(static_cast<int>(preset));
+        act->setChecked(preset == lumaPreset_);
+        if (preset == lumaPreset_) lumaPresetAction_ = act;
+        weightsGroup->addAction(act);
+    }
+    connect(weightsGroup, &QActionGroup::triggered, this, &MainWindow::onLumaWeightsSelected);
+
+    auto actDither = runMenu->addAction("Dither 16-bit Input to 8-bit");
+    actDither->setCheckable(true);
+    actDither->setChecked(ditherTo8_);
+    connect(actDither, &QAction::toggled, this, [this](bool on) { ditherTo8_ = on; });
+
     resultSource_ = new QComboBox(this);
     resultSource_->addItems({"C++", "ASM", "Python", "Fastest"});
     resultSource_->setStyleSheet(
@@ -121,14 +150,12 @@ void MainWindow::setupUi() {
             this, &MainWindow::onResultSourceChanged);
     menuBar()->setCornerWidget(resultSource_, Qt::TopRightCorner);
 
-    originalView_  = new QLabel("Drop or Open an image", this);
-    processedView_ = new QLabel("Processed will appear here", this);
-    originalView_->setAlignment(Qt::AlignCenter);
-    processedView_->setAlignment(Qt::AlignCenter);
-    originalView_->setMinimumSize(200,200);
-    processedView_->setMinimumSize(200,200);
-    originalView_->setStyleSheet("QLabel{background:#222;color:#bbb;border:1px solid #444;}");
-    processedView_->setStyleSheet("QLabel{background:#222;color:#bbb;border:1px solid #444;}");
+    originalView_  = new TiledImageView(this);
+    processedView_ = new TiledImageView(this);
+    originalView_->setPlaceholderText("Drop or Open an image");
+    processedView_->setPlaceholderText("Processed will appear here");
+    connect(originalView_, &TiledImageView::viewChanged, processedView_, &TiledImageView::setView);
+    connect(processedView_, &TiledImageView::viewChanged, originalView_, &TiledImageView::setView);
 
     processedContainer_ = new QWidget(this);
     processedStack_ = new QStackedLayout(processedContainer_);
@@ -224,7 +251,7 @@ void MainWindow::setupUi() {
 void MainWindow::onOpen() {
     const QString path = QFileDialog::getOpenFileName(
         this, "Open Image", QString(),
-        "Images (*.png *.jpg *.jpeg *.bmp *.gif *.tiff)");
+        "Images (*.png *.jpg *.jpeg *.bmp *.gif *.tif *.tiff)");
     if (!path.isEmpty()) loadImageFile(path);
 }
 
@@ -237,7 +264,6 @@ void MainWindow::loadImageFile(const QString& path) {
         return;
     }
     setOriginal(img);
-    processedView_->setText("Ready. Run All to process.");
 
     originalPath_ = path;
 
@@ -250,8 +276,9 @@ void MainWindow::loadImageFile(const QString& path) {
     asmNotes_ = "not run yet";
     pyNotes_  = "not run yet";
 
-    processedView_->setPixmap(QPixmap());
-    processedView_->setText("Ready. Run All to process.");
+    processedView_->clear();
+    processedView_->setPlaceholderText("Ready. Run All to process.");
+    originalView_->resetView();
 
     refreshPerfTable();
     updateSaveEnabled();
@@ -260,18 +287,13 @@ void MainWindow::loadImageFile(const QString& path) {
 
 void MainWindow::setOriginal(const QImage& img) {
     original_ = img;
-    scaleAndShow(originalView_, original_);
+    originalView_->setImage(original_);
 }
 
 void MainWindow::setProcessed(const QImage& img) {
-    scaleAndShow(processedView_, img);
-}
-
-void MainWindow::scaleAndShow(QLabel* label, const QImage& img) {
-    if (img.isNull()) { label->setText("No image"); return; }
-    const QSize area = label->size() * label->devicePixelRatioF();
-    QPixmap pm = QPixmap::fromImage(img);
-    label->setPixmap(pm.scaled(area, Qt::KeepAspectRatio, Qt::SmoothTransformation));
+    if (img.isNull()) processedView_->setPlaceholderText("No image");
+    processedView_->setView(originalView_->zoom(), originalView_->normalizedCenter());
+    processedView_->setImage(img);
 }
 
 void MainWindow::dragEnterEvent(QDragEnterEvent* e) {
@@ -285,17 +307,15 @@ void MainWindow::dropEvent(QDropEvent* e) {
     if (!path.isEmpty()) loadImageFile(path);
 }
 
-void MainWindow::resizeEvent(QResizeEvent* e) {
-    QMainWindow::resizeEvent(e);
-    if (!original_.isNull())  scaleAndShow(originalView_, original_);
-    if (!cppImg_.isNull() && resultSource_->currentIndex()==0)      setProcessed(cppImg_);
-    else if (!asmImg_.isNull() && resultSource_->currentIndex()==1) setProcessed(asmImg_);
-    else if (!pyImg_.isNull()  && resultSource_->currentIndex()==2) setProcessed(pyImg_);
-}
 QImage prepareImageForASM(const QImage& img) {
     return img.convertToFormat(QImage::Format_RGBA8888);
 }
 
+QImage prepareImageForASM16(const QImage& img) {
+    if (img.format() == QImage::Format_RGBA64 || img.format() == QImage::Format_RGBX64) return img;
+    return img.convertToFormat(QImage::Format_RGBA64);
+}
+
 
 void MainWindow::onRunAll() {
     if (original_.isNull()) {
@@ -309,8 +329,16 @@ void MainWindow::onRunAll() {
 
     QElapsedTimer t;
 
+    const noirify_cpp::LumaWeights weights = noirify_cpp::lumaWeights(lumaPreset_, customWeights_);
+
+    const bool highBitDepth = noirify_cpp::isHighBitDepth(original_);
+    const auto output16 = ditherTo8_ ? noirify_cpp::HighBitDepthOutput::Dithered8
+                                     : noirify_cpp::HighBitDepthOutput::Grayscale16;
+
     t.start();
-    cppImg_ = noirify_cpp::convertToGrayscale(original_);
+    cppImg_ = highBitDepth
+        ? noirify_cpp::convertToGrayscale16(original_, output16, lumaPreset_, customWeights_)
+        : noirify_cpp::convertToGrayscale(original_, lumaPreset_, customWeights_);
     cppMs_  = t.elapsed();
     cppNotes_ = cppImg_.isNull() ? "C++ processor failed" : "C++ processor executed successfully";
     refreshPerfTable();
@@ -323,20 +351,42 @@ void MainWindow::onRunAll() {
     QElapsedTimer tAsm;
     tAsm.start();
 
-    // Przygotowanie obrazu dla ASM
-    QImage asmCopy = prepareImageForASM(original_);
-    uint8_t* buffer = asmCopy.bits();
-    int width  = asmCopy.width();
-    int height = asmCopy.height();
+    if (highBitDepth) {
+        // 16-bit input is read in place and written straight to the output format
+        const QImage src16 = prepareImageForASM16(original_);
+        const auto* src = reinterpret_cast<const uint16_t*>(src16.constBits());
+
+        const noirify_cpp::LumaWeightsFixed fixed16 = noirify_cpp::toFixed(weights, 15);
+        set_rgb16(fixed16.r, fixed16.g, fixed16.b);
+
+        if (ditherTo8_) {
+            QImage out(src16.size(), QImage::Format_Grayscale8);
+            to_grayscale16_dither8(src, out.bits(), out.width(), out.height(),
+                                   int(src16.bytesPerLine()), int(out.bytesPerLine()));
+            asmImg_ = out;
+        } else {
+            QImage out(src16.size(), QImage::Format_Grayscale16);
+            to_grayscale16(src, reinterpret_cast<uint16_t*>(out.bits()), out.width(), out.height(),
+                           int(src16.bytesPerLine()), int(out.bytesPerLine()));
+            asmImg_ = out;
+        }
+    } else {
+        // Przygotowanie obrazu dla ASM
+        QImage asmCopy = prepareImageForASM(original_);
+        uint8_t* buffer = asmCopy.bits();
+        int width  = asmCopy.width();
+        int height = asmCopy.height();
 
-    // Ustawienie wag kolorów
-    set_rgb(77, 150, 29);
+        // Ustawienie wag kolorów
+        const noirify_cpp::LumaWeightsFixed fixed = noirify_cpp::toFixed(weights);
+        set_rgb(fixed.r, fixed.g, fixed.b);
 
-    // Wywołanie ASM
-    to_grayscale(buffer, width, height);
+        // Wywołanie ASM
+        to_grayscale(buffer, width, height);
 
-    // Zapis wyniku
-    asmImg_ = asmCopy;
+        // Zapis wyniku
+        asmImg_ = asmCopy;
+    }
     asmMs_ = tAsm.elapsed();
     asmNotes_ = "ASM processor executed successfully";
 
@@ -418,6 +468,57 @@ QString MainWindow::pythonScriptPath() const {
     return {};
 }
 
+QString MainWindow::pythonWeightsArg() const {
+    using noirify_cpp::LumaPreset;
+    switch (lumaPreset_) {
+        case LumaPreset::BT601:  return "bt601";
+        case LumaPreset::BT709:  return "bt709";
+        case LumaPreset::BT2020: return "bt2020";
+        case LumaPreset::Red:    return "red";
+        case LumaPreset::Green:  return "green";
+        case LumaPreset::Blue:   return "blue";
+        case LumaPreset::Custom: {
+            const auto w = noirify_cpp::lumaWeights(lumaPreset_, customWeights_);
+            return QString("%1,%2,%3").arg(w.r).arg(w.g).arg(w.b);
+        }
+    }
+    return "bt601";
+}
+
+void MainWindow::onLumaWeightsSelected(QAction* action) {
+    const auto preset = static_cast<noirify_cpp::LumaPreset>(action->data().toInt());
+
+    if (preset == noirify_cpp::LumaPreset::Custom) {
+        bool ok = false;
+        const QString current = QString("%1,%2,%3")
+            .arg(customWeights_.r).arg(customWeights_.g).arg(customWeights_.b);
+        const QString text = QInputDialog::getText(
+            this, "Custom Luma Weights", "R,G,B weights (normalized to sum 1):",
+            QLineEdit::Normal, current, &ok);
+
+        const QStringList parts = text.split(',');
+        bool valid = ok && parts.size() == 3;
+        noirify_cpp::LumaWeights w{};
+        if (valid) {
+            bool okR = false, okG = false, okB = false;
+            w = {parts[0].trimmed().toFloat(&okR), parts[1].trimmed().toFloat(&okG), parts[2].trimmed().toFloat(&okB)};
+            const float sum = w.r + w.g + w.b;
+            valid = okR && okG && okB && qIsFinite(w.r) && qIsFinite(w.g) && qIsFinite(w.b) && qIsFinite(sum)
+                    && w.r >= 0 && w.g >= 0 && w.b >= 0 && sum > 0;
+        }
+
+        if (!valid) {
+            if (ok) QMessageBox::warning(this, "Invalid weights", "Enter three finite, non-negative numbers, e.g. 0.3,0.59,0.11");
+            if (lumaPresetAction_) lumaPresetAction_->setChecked(true);
+            return;
+        }
+        customWeights_ = w;
+    }
+
+    lumaPreset_ = preset;
+    lumaPresetAction_ = action;
+}
+
 bool MainWindow::runPythonProcessor(const QString& inputPath, const QString& outputPath,
                                     qint64& elapsedMs, QString& notes) {
     const QString script = pythonScriptPath();
@@ -428,7 +529,7 @@ bool MainWindow::runPythonProcessor(const QString& inputPath, const QString& out
     }
 
     QProcess proc;
-    QStringList args{script, inputPath, outputPath};
+    QStringList args{script, inputPath, outputPath, pythonWeightsArg()};
 
     QElapsedTimer timer;
     timer.start();
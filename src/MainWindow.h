@@ -8,6 +8,8 @@
 #include <QToolButton>
 #include <QStackedLayout>
 #include <QTimer>
+#include "TiledImageView.h"
+#include "../processors/cpp/noirify_cpp.h"
 
 class ThrobberWidget : public QWidget {
     Q_OBJECT
@@ -33,22 +35,22 @@ public:
 protected:
     void dragEnterEvent(QDragEnterEvent* e) override;
     void dropEvent(QDropEvent* e) override;
-    void resizeEvent(QResizeEvent* e) override;
 
 private slots:
     void onOpen();
     void onRunAll();
     void onResultSourceChanged(int idx);
     void onSaveResult();
+    void onLumaWeightsSelected(QAction* action);
 
 private:
     void setupUi();
     void loadImageFile(const QString& path);
     void setOriginal(const QImage& img);
     void setProcessed(const QImage& img);
-    void scaleAndShow(QLabel* label, const QImage& img);
     void refreshPerfTable();
     QString pythonScriptPath() const;
+    QString pythonWeightsArg() const;
     bool runPythonProcessor(const QString& inputPath, const QString& outputPath, qint64& elapsedMs, QString& notes);
     void pumpEvents();
 
@@ -59,8 +61,13 @@ private:
     QString asmNotes_ = "not run yet";
     QString pyNotes_  = "not run yet";
 
-    QLabel* originalView_ = nullptr;
-    QLabel* processedView_ = nullptr;
+    noirify_cpp::LumaPreset lumaPreset_ = noirify_cpp::LumaPreset::BT601;
+    noirify_cpp::LumaWeights customWeights_{0.299f, 0.587f, 0.114f};
+    QAction* lumaPresetAction_ = nullptr;
+    bool ditherTo8_ = false;
+
+    TiledImageView* originalView_ = nullptr;
+    TiledImageView* processedView_ = nullptr;
     QWidget* processedContainer_ = nullptr;
     QStackedLayout* processedStack_ = nullptr;
     ThrobberWidget* throbber_ = nullptr;
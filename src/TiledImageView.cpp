@@ -0,0 +1,336 @@
+#include "TiledImageView.h"
+#include <QPainter>
+#include <QPaintEvent>
+#include <QResizeEvent>
+#include <QWheelEvent>
+#include <QMouseEvent>
+#include <QtConcurrent/QtConcurrentRun>
+#include <QtConcurrent/QtConcurrentMap>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr int BandRows = 64;
+    constexpr qreal MaxPixelScale = 32.0;
+    constexpr int TileCacheKb = 256 * 1024;
+
+    bool isNativeFormat(QImage::Format f) {
+        return f == QImage::Format_Grayscale8
+            || f == QImage::Format_RGB32
+            || f == QImage::Format_ARGB32_Premultiplied;
+    }
+}
+
+TiledImageView::TiledImageView(QWidget* parent) : QWidget(parent) {
+    setMinimumSize(200, 200);
+    tiles_.setMaxCost(TileCacheKb);
+
+    resizeDebounce_.setSingleShot(true);
+    resizeDebounce_.setInterval(120);
+    connect(&resizeDebounce_, &QTimer::timeout, this, [this] {
+        resizing_ = false;
+        update();
+    });
+
+    connect(&buildWatcher_, &QFutureWatcher<std::shared_ptr<const Pyramid>>::finished,
+            this, &TiledImageView::onPyramidReady);
+}
+
+TiledImageView::~TiledImageView() {
+    cancelBuild();
+    buildWatcher_.waitForFinished();
+}
+
+void TiledImageView::setImage(const QImage& img) {
+    if (img.isNull()) { clear(); return; }
+
+    cancelBuild();
+    // A same-size result swap keeps the old pyramid on screen until the new one is ready;
+    // a different image would be drawn at the wrong geometry, so show the placeholder instead.
+    if (img.size() != imageSize_) {
+        pyramid_.reset();
+        tiles_.clear();
+        imageSize_ = img.size();
+        applyView(zoom_, center_);
+    }
+    buildCancelled_ = std::make_shared<std::atomic_bool>(false);
+    buildWatcher_.setFuture(QtConcurrent::run(&TiledImageView::buildPyramid, img, buildCancelled_));
+    update();
+}
+
+void TiledImageView::clear() {
+    cancelBuild();
+    buildWatcher_.setFuture(QFuture<std::shared_ptr<const Pyramid>>());
+    pyramid_.reset();
+    tiles_.clear();
+    imageSize_ = {};
+    update();
+}
+
+void TiledImageView::setPlaceholderText(const QString& text) {
+    placeholder_ = text;
+    if (!pyramid_) update();
+}
+
+void TiledImageView::cancelBuild() {
+    if (buildCancelled_) *buildCancelled_ = true;
+    buildCancelled_.reset();
+}
+
+void TiledImageView::onPyramidReady() {
+    // clear() may have run after the build returned but before this queued signal arrived.
+    if (!buildCancelled_ || *buildCancelled_) return;
+
+    auto result = buildWatcher_.result();
+    if (!result || result->levels.isEmpty()) return;
+
+    const QSize newSize = result->levels.first().size();
+    pyramid_ = std::move(result);
+    tiles_.clear();
+    if (newSize != imageSize_) {
+        imageSize_ = newSize;
+        applyView(zoom_, center_);
+    }
+    update();
+}
+
+std::shared_ptr<const TiledImageView::Pyramid> TiledImageView::buildPyramid(
+        QImage src, std::shared_ptr<std::atomic_bool> cancelled) {
+    if (!isNativeFormat(src.format())) {
+        src = src.convertToFormat(src.isGrayscale() ? QImage::Format_Grayscale8
+                                                    : QImage::Format_ARGB32_Premultiplied);
+    }
+
+    auto pyramid = std::make_shared<Pyramid>();
+    pyramid->levels.push_back(src);
+    while (qMax(pyramid->levels.last().width(), pyramid->levels.last().height()) > TileSize) {
+        if (*cancelled) return {};
+        pyramid->levels.push_back(downsample(pyramid->levels.last()));
+    }
+    if (*cancelled) return {};
+    return pyramid;
+}
+
+// 2x2 box filter, rows split into bands that run on the global thread pool.
+// Works for both 1-byte (grayscale) and 4-byte (premultiplied RGB) pixels.
+QImage TiledImageView::downsample(const QImage& src) {
+    const int sw = src.width(), sh = src.height();
+    const int dw = qMax(1, (sw + 1) / 2), dh = qMax(1, (sh + 1) / 2);
+    const int bpp = src.depth() / 8;
+
+    QImage dst(dw, dh, src.format());
+    const uchar* srcBits = src.constBits();
+    uchar* dstBits = dst.bits();
+    const qsizetype srcBpl = src.bytesPerLine();
+    const qsizetype dstBpl = dst.bytesPerLine();
+
+    QList<int> bands;
+    for (int y = 0; y < dh; y += BandRows) bands.push_back(y);
+
+    QtConcurrent::blockingMap(bands, [=](int y0) {
+        const int y1 = qMin(y0 + BandRows, dh);
+        for (int y = y0; y < y1; ++y) {
+            const uchar* r0 = srcBits + qsizetype(2 * y) * srcBpl;
+            const uchar* r1 = srcBits + qsizetype(qMin(2 * y + 1, sh - 1)) * srcBpl;
+            uchar* out = dstBits + qsizetype(y) * dstBpl;
+            for (int x = 0; x < dw; ++x) {
+                const int x0 = 2 * x * bpp;
+                const int x1 = qMin(2 * x + 1, sw - 1) * bpp;
+                for (int c = 0; c < bpp; ++c) {
+                    out[x * bpp + c] = static_cast<uchar>(
+                        (r0[x0 + c] + r0[x1 + c] + r1[x0 + c] + r1[x1 + c] + 2) >> 2);
+                }
+            }
+        }
+    });
+
+    return dst;
+}
+
+qreal TiledImageView::displayScale() const {
+    if (imageSize_.isEmpty()) return 1.0;
+    const qreal fit = qMin(qreal(width()) / imageSize_.width(),
+                           qreal(height()) / imageSize_.height());
+    return fit * zoom_;
+}
+
+QPointF TiledImageView::imageOrigin(qreal scale) const {
+    return {width() / 2.0 - center_.x() * imageSize_.width() * scale,
+            height() / 2.0 - center_.y() * imageSize_.height() * scale};
+}
+
+int TiledImageView::levelForScale(qreal physicalScale) const {
+    if (!pyramid_ || physicalScale >= 1.0) return 0;
+    const int level = static_cast<int>(std::floor(std::log2(1.0 / physicalScale)));
+    return std::clamp(level, 0, int(pyramid_->levels.size()) - 1);
+}
+
+const QPixmap* TiledImageView::tilePixmap(int level, int tx, int ty) {
+    const quint64 key = (quint64(level) << 48) | (quint64(ty) << 24) | quint64(tx);
+    if (const QPixmap* cached = tiles_.object(key)) return cached;
+
+    const QImage& li = pyramid_->levels[level];
+    const int x = tx * TileSize, y = ty * TileSize;
+    const int w = qMin(TileSize, li.width() - x);
+    const int h = qMin(TileSize, li.height() - y);
+    const QImage view(li.constBits() + qsizetype(y) * li.bytesPerLine() + qsizetype(x) * (li.depth() / 8),
+                      w, h, li.bytesPerLine(), li.format());
+
+    auto* pm = new QPixmap(QPixmap::fromImage(view));
+    const int costKb = qMax(1, int(qsizetype(w) * h * pm->depth() / 8 / 1024));
+    if (!tiles_.insert(key, pm, costKb)) return nullptr;
+    return tiles_.object(key);
+}
+
+qreal TiledImageView::clampZoom(qreal zoom) const {
+    qreal z = qMax<qreal>(1.0, zoom);
+    if (!imageSize_.isEmpty() && width() > 0 && height() > 0) {
+        const qreal fit = qMin(qreal(width()) / imageSize_.width(),
+                               qreal(height()) / imageSize_.height());
+        z = qMin(z, qMax<qreal>(1.0, MaxPixelScale / fit));
+    }
+    return z;
+}
+
+bool TiledImageView::applyView(qreal zoom, const QPointF& normalizedCenter) {
+    const qreal z = clampZoom(zoom);
+    QPointF c = normalizedCenter;
+
+    if (!imageSize_.isEmpty() && width() > 0 && height() > 0) {
+        const qreal fit = qMin(qreal(width()) / imageSize_.width(),
+                               qreal(height()) / imageSize_.height());
+        const qreal scale = fit * z;
+        const qreal hx = width() / 2.0 / (imageSize_.width() * scale);
+        const qreal hy = height() / 2.0 / (imageSize_.height() * scale);
+        c.setX(hx >= 0.5 ? 0.5 : std::clamp(c.x(), hx, 1.0 - hx));
+        c.setY(hy >= 0.5 ? 0.5 : std::clamp(c.y(), hy, 1.0 - hy));
+    }
+
+    if (qFuzzyCompare(z, zoom_) && qFuzzyCompare(c.x() + 1.0, center_.x() + 1.0)
+        && qFuzzyCompare(c.y() + 1.0, center_.y() + 1.0)) {
+        return false;
+    }
+    zoom_ = z;
+    center_ = c;
+    update();
+    return true;
+}
+
+void TiledImageView::setView(qreal zoom, const QPointF& normalizedCenter) {
+    applyView(zoom, normalizedCenter);
+}
+
+void TiledImageView::resetView() {
+    if (applyView(1.0, {0.5, 0.5})) emit viewChanged(zoom_, center_);
+}
+
+void TiledImageView::paintEvent(QPaintEvent* event) {
+    Q_UNUSED(event);
+    QPainter p(this);
+    p.fillRect(rect(), QColor(0x22, 0x22, 0x22));
+    p.setPen(QColor(0x44, 0x44, 0x44));
+    p.drawRect(rect().adjusted(0, 0, -1, -1));
+
+    if (!pyramid_) {
+        p.setPen(QColor(0xbb, 0xbb, 0xbb));
+        p.drawText(rect(), Qt::AlignCenter, placeholder_);
+        return;
+    }
+
+    const qreal scale = displayScale();
+    const QPointF origin = imageOrigin(scale);
+    const int level = levelForScale(scale * devicePixelRatioF());
+    const QImage& li = pyramid_->levels[level];
+    const qreal fx = qreal(imageSize_.width()) / li.width() * scale;
+    const qreal fy = qreal(imageSize_.height()) / li.height() * scale;
+
+    // Visible region in level pixels.
+    const QRectF visible = QRectF(-origin.x() / fx, -origin.y() / fy, width() / fx, height() / fy)
+                               .intersected(QRectF(0, 0, li.width(), li.height()));
+    if (visible.isEmpty()) return;
+
+    const int maxTx = (li.width() - 1) / TileSize;
+    const int maxTy = (li.height() - 1) / TileSize;
+    const int tx0 = std::clamp(int(visible.left()) / TileSize, 0, maxTx);
+    const int ty0 = std::clamp(int(visible.top()) / TileSize, 0, maxTy);
+    const int tx1 = std::clamp(int(std::ceil(visible.right())) / TileSize, 0, maxTx);
+    const int ty1 = std::clamp(int(std::ceil(visible.bottom())) / TileSize, 0, maxTy);
+
+    p.setClipRect(rect().adjusted(1, 1, -1, -1));
+    p.setRenderHint(QPainter::SmoothPixmapTransform, !resizing_);
+
+    // Tile edges are snapped so neighbours share the same device pixel and no seams appear.
+    auto edgeX = [&](int lx) { return std::round(origin.x() + lx * fx); };
+    auto edgeY = [&](int ly) { return std::round(origin.y() + ly * fy); };
+
+    for (int ty = ty0; ty <= ty1; ++ty) {
+        const int ly0 = ty * TileSize, ly1 = qMin(li.height(), ly0 + TileSize);
+        for (int tx = tx0; tx <= tx1; ++tx) {
+            const int lx0 = tx * TileSize, lx1 = qMin(li.width(), lx0 + TileSize);
+            const QPixmap* pm = tilePixmap(level, tx, ty);
+            if (!pm) continue;
+            const QRectF target(QPointF(edgeX(lx0), edgeY(ly0)), QPointF(edgeX(lx1), edgeY(ly1)));
+            p.drawPixmap(target, *pm, QRectF(pm->rect()));
+        }
+    }
+}
+
+void TiledImageView::resizeEvent(QResizeEvent* event) {
+    QWidget::resizeEvent(event);
+    resizing_ = true;
+    resizeDebounce_.start();
+    applyView(zoom_, center_);
+}
+
+void TiledImageView::wheelEvent(QWheelEvent* event) {
+    if (imageSize_.isEmpty()) { event->ignore(); return; }
+
+    const qreal oldScale = displayScale();
+    const QPointF pos = event->position();
+    const QPointF anchor = (pos - imageOrigin(oldScale)) / oldScale;
+
+    const qreal factor = std::pow(1.0015, event->angleDelta().y());
+    const qreal newZoom = clampZoom(zoom_ * factor);
+    const qreal newScale = oldScale * (newZoom / zoom_);
+    const QPointF newOrigin = pos - anchor * newScale;
+    const QPointF newCenter((width() / 2.0 - newOrigin.x()) / newScale / imageSize_.width(),
+                            (height() / 2.0 - newOrigin.y()) / newScale / imageSize_.height());
+
+    if (applyView(newZoom, newCenter)) emit viewChanged(zoom_, center_);
+    event->accept();
+}
+
+void TiledImageView::mousePressEvent(QMouseEvent* event) {
+    if (event->button() != Qt::LeftButton || imageSize_.isEmpty()) {
+        QWidget::mousePressEvent(event);
+        return;
+    }
+    panning_ = true;
+    panAnchor_ = event->position();
+    setCursor(Qt::ClosedHandCursor);
+}
+
+void TiledImageView::mouseMoveEvent(QMouseEvent* event) {
+    if (!panning_) { QWidget::mouseMoveEvent(event); return; }
+
+    const QPointF delta = event->position() - panAnchor_;
+    panAnchor_ = event->position();
+    const qreal scale = displayScale();
+    const QPointF newCenter(center_.x() - delta.x() / (scale * imageSize_.width()),
+                            center_.y() - delta.y() / (scale * imageSize_.height()));
+    if (applyView(zoom_, newCenter)) emit viewChanged(zoom_, center_);
+}
+
+void TiledImageView::mouseReleaseEvent(QMouseEvent* event) {
+    if (event->button() == Qt::LeftButton && panning_) {
+        panning_ = false;
+        unsetCursor();
+        return;
+    }
+    QWidget::mouseReleaseEvent(event);
+}
+
+void TiledImageView::mouseDoubleClickEvent(QMouseEvent* event) {
+    Q_UNUSED(event);
+    resetView();
+}
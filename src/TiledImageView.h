@@ -0,0 +1,82 @@
+#pragma once
+#include <QWidget>
+#include <QImage>
+#include <QPixmap>
+#include <QCache>
+#include <QTimer>
+#include <QPointF>
+#include <QFutureWatcher>
+#include <atomic>
+#include <memory>
+
+// Image viewer backed by a mip pyramid that is built once in the background.
+// Only the tiles intersecting the viewport are drawn, from the level that
+// matches the current display scale, so resize/zoom cost does not depend on
+// the source resolution.
+class TiledImageView : public QWidget {
+    Q_OBJECT
+public:
+    explicit TiledImageView(QWidget* parent = nullptr);
+    ~TiledImageView() override;
+
+    void setImage(const QImage& img);
+    void clear();
+    void setPlaceholderText(const QString& text);
+
+    qreal zoom() const { return zoom_; }
+    QPointF normalizedCenter() const { return center_; }
+
+public slots:
+    // zoom is relative to fit-to-view (1.0 = whole image visible),
+    // center is in image coordinates normalized to [0, 1].
+    void setView(qreal zoom, const QPointF& normalizedCenter);
+    void resetView();
+
+signals:
+    void viewChanged(qreal zoom, const QPointF& normalizedCenter);
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
+    void wheelEvent(QWheelEvent* event) override;
+    void mousePressEvent(QMouseEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
+    void mouseReleaseEvent(QMouseEvent* event) override;
+    void mouseDoubleClickEvent(QMouseEvent* event) override;
+
+private:
+    struct Pyramid {
+        QList<QImage> levels;
+    };
+
+    static std::shared_ptr<const Pyramid> buildPyramid(QImage src,
+                                                       std::shared_ptr<std::atomic_bool> cancelled);
+    static QImage downsample(const QImage& src);
+
+    void onPyramidReady();
+    void cancelBuild();
+    qreal displayScale() const;
+    QPointF imageOrigin(qreal scale) const;
+    int levelForScale(qreal physicalScale) const;
+    const QPixmap* tilePixmap(int level, int tx, int ty);
+    qreal clampZoom(qreal zoom) const;
+    bool applyView(qreal zoom, const QPointF& normalizedCenter);
+
+    static constexpr int TileSize = 256;
+
+    QSize imageSize_;
+    std::shared_ptr<const Pyramid> pyramid_;
+    std::shared_ptr<std::atomic_bool> buildCancelled_;
+    QFutureWatcher<std::shared_ptr<const Pyramid>> buildWatcher_;
+    QCache<quint64, QPixmap> tiles_;
+
+    QString placeholder_;
+    qreal zoom_ = 1.0;
+    QPointF center_{0.5, 0.5};
+
+    bool panning_ = false;
+    QPointF panAnchor_;
+
+    QTimer resizeDebounce_;
+    bool resizing_ = false;
+};